@@ -599,6 +599,15 @@ typedef struct GumboInternalOptions {
    * Default: 50
    */
   int max_errors;
+
+  /**
+   * Whether or not to track source line/column numbers for nodes and
+   * attributes.  Byte offsets are always tracked.  Disabling this skips the
+   * per-character position bookkeeping, which speeds up throwaway parses
+   * that never need to report positions back to the user.
+   * Default: true.
+   */
+  bool track_source_positions;
 } GumboOptions;
 
 /** Default options struct; use this with gumbo_parse_with_options. */
@@ -60,6 +60,7 @@ const GumboOptions kGumboDefaultOptions = {
   false,   /* stop_on_first_error */
   400,     /* max_tree_depth */
   50,      /* max_errors */
+  true,    /* track_source_positions */
 };
 
 static const GumboStringPiece kDoctypeHtml = GUMBO_STRING("html");
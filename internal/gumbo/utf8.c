@@ -177,6 +177,9 @@ static void read_char(Utf8Iterator* iter) {
 
 static void update_position(Utf8Iterator* iter) {
   iter->_pos.offset += iter->_width;
+  if (!iter->_parser->_options->track_source_positions) {
+    return;
+  }
   if (iter->_current == '\n') {
     ++iter->_pos.line;
     iter->_pos.column = 1;
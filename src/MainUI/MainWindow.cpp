@@ -243,7 +243,7 @@ MainWindow::MainWindow(const QString &openfilepath,
     m_SaveLastEnabled(false),
     m_PreviousHTMLResource(NULL),
     m_PreviousHTMLText(QString()),
-    m_PreviousHTMLLocation(QList<ElementIndex>()),
+    m_PreviousHTMLLocation(QVector<ElementIndex>()),
     m_menuPluginsInput(NULL),
     m_menuPluginsOutput(NULL),
     m_menuPluginsEdit(NULL),
@@ -3567,7 +3567,7 @@ void MainWindow::RemoveResources(QList<Resource *> resources)
     if (!current_resources.contains(m_PreviousHTMLResource)) {
         m_PreviousHTMLResource = NULL;
         m_PreviousHTMLText = "";
-        m_PreviousHTMLLocation = QList<ElementIndex>();
+        m_PreviousHTMLLocation = QVector<ElementIndex>();
     }
 
     ShowMessageOnStatusBar(tr("File(s) deleted."));
@@ -4384,7 +4384,7 @@ void MainWindow::UpdatePreviewCSSRequest()
 void MainWindow::ScrollPreview()
 {
     DBG qDebug() << "in ScrollPreview called from FlowTab";
-    QList<ElementIndex> location;
+    QVector<ElementIndex> location;
     HTMLResource *html_resource;
 
     ContentTab *tab = GetCurrentContentTab();
@@ -4417,7 +4417,7 @@ void MainWindow::UpdatePreview()
     DBG qDebug() << "MW: UpdatePreview()";
 
     QString text;
-    QList<ElementIndex> location;
+    QVector<ElementIndex> location;
     HTMLResource *html_resource;
 
     ContentTab *tab = GetCurrentContentTab();
@@ -4471,7 +4471,9 @@ void MainWindow::UpdatePreview()
             m_PreviousHTMLText = text;
             m_PreviousHTMLLocation = location;
 
-            bool res = m_PreviewWindow->UpdatePage(html_resource->GetFullPath(), text, location);
+            // text is not needed again here so move it in to avoid a deep
+            // copy once Preview modifies its own copy in place
+            bool res = m_PreviewWindow->UpdatePage(html_resource->GetFullPath(), std::move(text), location);
             if (!res) {
                 m_PreviewTimer.start();
             }
@@ -1032,7 +1032,7 @@ private:
 
     HTMLResource *m_PreviousHTMLResource;
     QString m_PreviousHTMLText;
-    QList<ElementIndex> m_PreviousHTMLLocation;
+    QVector<ElementIndex> m_PreviousHTMLLocation;
 
     /**
      * dynamically updated plugin menus and actions
@@ -21,6 +21,14 @@
 **
 *************************************************************************/
 
+#include <cctype>
+#include <cstring>
+
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+#define SIGIL_USE_AVX2_SCAN 1
+#include <immintrin.h>
+#endif
+
 #include <QEvent>
 #include <QMouseEvent>
 #include <QApplication>
@@ -32,10 +40,12 @@
 #include <QDir>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
+#include <QStringBuilder>
 #include <QStylePainter>
 #include <QStyleOptionFrame>
 #include <QTimer>
 #include <QProgressBar>
+#include <QLoggingCategory>
 #include <QDebug>
 
 #include "MainUI/PreviewWindow.h"
@@ -48,8 +58,6 @@
 #include "ViewEditors/Overlay.h"
 #include "sigil_constants.h"
 
-static const QStringList HEADERTAGS = QStringList() << "h1" << "h2" << "h3" << "h4" << "h5" << "h6";
-
 static const QString SETTINGS_GROUP = "previewwindow";
 
 static const QString MATHJAX_CLEANUP = 
@@ -64,7 +72,43 @@ static const QString MATHJAX_CLEANUP =
    "</script>";;
 
 
-#define DBG if(0)
+Q_LOGGING_CATEGORY(lcPreview, "sigil.preview", QtWarningMsg)
+
+// Find "</head>" in text by scanning the raw utf-16 buffer for the '<'
+// sentinel 16 code units at a time and only then verifying the tail.
+// QString::indexOf walks the buffer one QChar at a time, which shows up
+// on multi-MB chapters; this step is purely memory bound so wider loads
+// pay off directly.  Falls back to indexOf where AVX2 is unavailable.
+static int find_end_of_head(const QString &text)
+{
+#if defined(SIGIL_USE_AVX2_SCAN)
+    const ushort *p = reinterpret_cast<const ushort *>(text.constData());
+    const int n = text.size();
+    static const ushort needle[7] = {'<','/','h','e','a','d','>'};
+    const __m256i lt = _mm256_set1_epi16('<');
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        // one even bit per matching 16-bit lane
+        unsigned int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(chunk, lt)) & 0x55555555u;
+        while (mask) {
+            const int idx = i + (__builtin_ctz(mask) >> 1);
+            if ((idx + 7 <= n) && (memcmp(p + idx, needle, sizeof(needle)) == 0)) {
+                return idx;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; i + 7 <= n; i++) {
+        if ((p[i] == '<') && (memcmp(p + i, needle, sizeof(needle)) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+#else
+    return text.indexOf(QLatin1String("</head>"));
+#endif
+}
 
 PreviewWindow::PreviewWindow(QWidget *parent)
     :
@@ -74,19 +118,25 @@ PreviewWindow::PreviewWindow(QWidget *parent)
     m_buttons(new QHBoxLayout()),
     m_overlayBase(new OverlayHelperWidget(this)),
     m_Preview(new ViewPreview(m_overlayBase)),
-    m_Inspector(new Inspector(this)),
-    m_progress(new QProgressBar(this)),
+    m_Inspector(nullptr),
+    m_progress(nullptr),
+    m_toolbar(nullptr),
     m_Filepath(QString()),
     m_titleText(QString()),
+    m_lastTitleWidth(-1),
+    m_lastTitleHeight(-1),
+    m_lastTextSize(-1),
+    m_lastTextHash(0),
+    m_lastDark(false),
+    m_havePending(false),
     m_updatingPage(false),
-    m_usingMathML(false)
+    m_usingMathML(false),
+    m_optDirty(true)
 {
-    m_progress->reset();
-    m_progress->setMinimum(0);
-    m_progress->setMaximum(100);
     setWindowTitle(tr("Preview"));
     SetupView();
     SetupOverlayTimer();
+    SetupDebounceTimer();
     LoadSettings();
     ConnectSignalsToSlots();
 }
@@ -134,13 +184,56 @@ void PreviewWindow::ShowOverlay()
     m_Preview->ShowOverlay();
 }
 
+Inspector *PreviewWindow::inspector()
+{
+    if (!m_Inspector) {
+        m_Inspector = new Inspector(this);
+        connect(m_Inspector, SIGNAL(finished(int)), this, SLOT(InspectorClosed(int)));
+    }
+    return m_Inspector;
+}
+
+QProgressBar *PreviewWindow::progress()
+{
+    if (!m_progress) {
+        m_progress = new QProgressBar(this);
+        m_progress->reset();
+        m_progress->setMinimum(0);
+        m_progress->setMaximum(100);
+        m_toolbar->addWidget(m_progress);
+    }
+    return m_progress;
+}
+
+void PreviewWindow::SetupDebounceTimer()
+{
+    // coalesces bursts of UpdatePage requests (one per keystroke while
+    // typing) so that only the most recent document text gets rendered
+    m_DebounceTimer.setSingleShot(true);
+    m_DebounceTimer.setInterval(120);
+    connect(&m_DebounceTimer, SIGNAL(timeout()), this, SLOT(DoUpdatePage()));
+}
+
 void PreviewWindow::resizeEvent(QResizeEvent *event)
 {
     // Update self normally
+    m_optDirty = true;
     QDockWidget::resizeEvent(event);
     UpdateWindowTitle();
 }
 
+void PreviewWindow::moveEvent(QMoveEvent *event)
+{
+    m_optDirty = true;
+    QDockWidget::moveEvent(event);
+}
+
+void PreviewWindow::changeEvent(QEvent *event)
+{
+    m_optDirty = true;
+    QDockWidget::changeEvent(event);
+}
+
 
 void PreviewWindow::hideEvent(QHideEvent * event)
 {
@@ -163,6 +256,11 @@ void PreviewWindow::showEvent(QShowEvent * event)
 
     QDockWidget::showEvent(event);
     raise();
+
+    // render any refresh request that was buffered while hidden
+    if (m_havePending) {
+        m_DebounceTimer.start();
+    }
     emit Shown();
 }
 
@@ -172,15 +270,22 @@ void PreviewWindow::paintEvent(QPaintEvent *event)
     // (when QDockWidget is tabified).
     QStylePainter painter(this);
 
+    // initStyleOption queries a lot of widget state; rebuild the cached
+    // options only when that state has changed, not on every repaint
+    if (m_optDirty) {
+        if (isFloating()) {
+            m_cachedFrameOpt = QStyleOptionFrame();
+            m_cachedFrameOpt.initFrom(this);
+        }
+        m_cachedOpt = QStyleOptionDockWidget();
+        initStyleOption(&m_cachedOpt);
+        m_optDirty = false;
+    }
     if (isFloating()) {
-        QStyleOptionFrame options;
-        options.initFrom(this);
-        painter.drawPrimitive(QStyle::PE_FrameDockWidget, options);
+        painter.drawPrimitive(QStyle::PE_FrameDockWidget, m_cachedFrameOpt);
     }
-    QStyleOptionDockWidget options;
-    initStyleOption(&options);
-    options.title = titleText();
-    painter.drawControl(QStyle::CE_DockWidgetTitle, options);
+    m_cachedOpt.title = titleText();
+    painter.drawControl(QStyle::CE_DockWidgetTitle, m_cachedOpt);
 }
 
 bool PreviewWindow::IsVisible()
@@ -229,14 +334,14 @@ void PreviewWindow::SetupView()
     m_reloadAction  = new QAction(QIcon(":/main/reload-page.svg"),"", this);
     m_reloadAction->setToolTip(tr("Update Preview Window"));
 
-    QToolBar * tb = new QToolBar();
-    tb->addAction(m_inspectAction);
-    tb->addAction(m_selectAction);
-    tb->addAction(m_copyAction);
-    tb->addAction(m_reloadAction);
-    tb->addWidget(m_progress);
+    m_toolbar = new QToolBar();
+    m_toolbar->addAction(m_inspectAction);
+    m_toolbar->addAction(m_selectAction);
+    m_toolbar->addAction(m_copyAction);
+    m_toolbar->addAction(m_reloadAction);
+    // the progress bar is created and added on first use - see progress()
 
-    m_buttons->addWidget(tb);
+    m_buttons->addWidget(m_toolbar);
     m_Layout->addLayout(m_buttons);
 
     m_MainWidget->setLayout(m_Layout);
@@ -251,116 +356,216 @@ void PreviewWindow::SetupView()
 // to Zoom() as it is not properly zooming after loading
 // But Zoom() is not done synchronously so after zooming
 // you must delay before trying to update Preview to a specific location
-bool PreviewWindow::UpdatePage(QString filename_url, QString text, QList<ElementIndex> location)
+bool PreviewWindow::UpdatePage(const QString &filename_url, QString text, const QVector<ElementIndex> &location)
 {
 
-    DBG qDebug() << "Entered PV UpdatePage with filename: " << filename_url;
+    qCDebug(lcPreview) << "Entered PV UpdatePage with filename: " << filename_url;
+
+    // buffer the request and (re)start the debounce timer; intermediate
+    // states of a typing burst are simply overwritten before they render
+    m_pendingUrl = filename_url;
+    m_pendingText = std::move(text);
+    m_pendingLocation = location;
+    m_havePending = true;
 
     if (!m_Preview->isVisible()) {
-        DBG qDebug() << "ignoring PV UpdatePage since PV is not visible";
+        // no work while hidden; showEvent replays the newest request
+        qCDebug(lcPreview) << "buffering PV UpdatePage since PV is not visible";
         return true;
     }
 
+    m_DebounceTimer.start();
+    return true;
+}
+
+void PreviewWindow::DoUpdatePage()
+{
+    if (!m_havePending) return;
+
+    if (!m_Preview->isVisible()) {
+        // leave the request buffered for showEvent to replay
+        return;
+    }
+
     if (m_updatingPage) {
-        DBG qDebug() << "delaying PV UpdatePage request as currently loading a page: ";
-        return false;
+        // a page load is still in flight; UpdatePageDone re-arms the timer
+        qCDebug(lcPreview) << "delaying PV UpdatePage request as currently loading a page: ";
+        return;
+    }
+
+    const QString filename_url = m_pendingUrl;
+    QString text = std::move(m_pendingText);
+    m_pendingText = QString();
+    m_havePending = false;
+
+    SettingsStore settings;
+    const bool usedark = Utility::IsDarkMode() && settings.previewDark();
+    // hash (and size, to cheaply rule out collisions) of the document as
+    // delivered, before any head injections are applied
+    const uint texthash = qHash(text);
+    const int textsize = text.size();
+
+    // if the chapter itself is unchanged and only the user stylesheet
+    // differs from what the loaded page was built with, swap the tagged
+    // <link> inside the existing page instead of pushing the document
+    // back through Chromium's full parse/layout/paint pipeline
+    if ((filename_url == m_Filepath) && (textsize == m_lastTextSize) &&
+        (texthash == m_lastTextHash) && (usedark == m_lastDark) &&
+        (m_usercssurl != m_lastUserCssUrl)) {
+        // escape the url for splicing into a single-quoted js string
+        // (think apostrophes in home directory names)
+        QString jsurl = m_usercssurl;
+        jsurl.replace(QLatin1String("\\"), QLatin1String("\\\\"));
+        jsurl.replace(QLatin1String("'"), QLatin1String("\\'"));
+        m_Preview->page()->runJavaScript(QString(
+            "(function(){"
+            "var l=document.getElementById('__sigil_user_css');"
+            "if(l)l.parentNode.removeChild(l);"
+            "if('%1'!==''){"
+            "l=document.createElement('link');"
+            "l.id='__sigil_user_css';"
+            "l.rel='stylesheet';l.type='text/css';l.href='%1';"
+            "document.head.appendChild(l);}"
+            "})();").arg(jsurl));
+        m_lastUserCssUrl = m_usercssurl;
+        SetCaretLocation(m_pendingLocation);
+        return;
     }
 
     m_updatingPage = true;
-    SetCaretLocation(location);
-    m_progress->setRange(0,100);
-    m_progress->setValue(0);
+    SetCaretLocation(m_pendingLocation);
+    progress()->setRange(0,100);
+    progress()->setValue(0);
     m_OverlayTimer.start();
 
-    QRegularExpression mathused("<\\s*math [^>]*>");
-    QRegularExpressionMatch mo = mathused.match(text);
-    m_usingMathML = mo.hasMatch();
+    // almost no chapters use mathml, so probe for the literal "<math"
+    // first and only run the regex (from the probe position) when it hits
+    m_usingMathML = false;
+    const int mathpos = text.indexOf(QLatin1String("<math"), 0, Qt::CaseInsensitive);
+    if (mathpos >= 0) {
+        // compiled once per process, match() on a const QRegularExpression is thread-safe
+        static const QRegularExpression mathused(QStringLiteral("<\\s*math [^>]*>"));
+        m_usingMathML = mathused.match(text, mathpos).hasMatch();
+    }
+
+    qCDebug(lcPreview) << "PV UpdatePage " << filename_url;
+    if (lcPreview().isDebugEnabled()) {
+        for (const ElementIndex &ei : m_pendingLocation) {
+            qCDebug(lcPreview) << "PV name: " << ei.name << " index: " << ei.index;
+        }
+    }
+
 
-    DBG qDebug() << "PV UpdatePage " << filename_url;
-    DBG foreach(ElementIndex ei, location) qDebug()<< "PV name: " << ei.name << " index: " << ei.index;
+    // locate the end of head just once and share it across all injections
+    const int endheadpos = find_end_of_head(text);
 
+    QString injections;
+    injections.reserve(256);
 
     //if isDarkMode is set, inject a local style in head
-    SettingsStore settings;
-    if (Utility::IsDarkMode() && settings.previewDark()) {
-        text = Utility::AddDarkCSS(text);
-        DBG qDebug() << "Preview injecting dark style: ";
+    if (usedark) {
+        injections += Utility::GetDarkCSS();
+        qCDebug(lcPreview) << "Preview injecting dark style: ";
     }
     m_Preview->page()->setBackgroundColor(Utility::WebViewBackgroundColor(true));
 
     // If the user has set a default stylesheet inject it
     // it can override anything above it
     if (!m_usercssurl.isEmpty()) {
-        int endheadpos = text.indexOf("</head>");
-        if (endheadpos > 1) {
-            QString inject_userstyles = 
-              "<link rel=\"stylesheet\" type=\"text/css\" "
-              "href=\"" + m_usercssurl + "\" />\n";
-            DBG qDebug() << "Preview injecting stylesheet: " << inject_userstyles;
-            text.insert(endheadpos, inject_userstyles);
-        }
+        QString inject_userstyles =
+          QLatin1String("<link id=\"__sigil_user_css\" rel=\"stylesheet\" type=\"text/css\" href=\"") %
+          m_usercssurl % QLatin1String("\" />\n");
+        qCDebug(lcPreview) << "Preview injecting stylesheet: " << inject_userstyles;
+        injections += inject_userstyles;
     }
 
     // If this page uses mathml tags, inject a polyfill
     // MathJax.js so that the mathml appears in the Preview Window
     if (m_usingMathML) {
-        int endheadpos = text.indexOf("</head>");
-        if (endheadpos > 1) {
-            QString inject_mathjax = MATHJAX_CLEANUP + 
-              "<script type=\"text/javascript\" async=\"async\" "
-              "src=\"" + m_mathjaxurl + "\"></script>\n";
-            text.insert(endheadpos, inject_mathjax);
-        }
+        injections += MATHJAX_CLEANUP %
+          QLatin1String("<script id=\"__sigil_mathjax\" type=\"text/javascript\" async=\"async\" src=\"") %
+          m_mathjaxurl % QLatin1String("\"></script>\n");
     }
 
-    if (fixup_fullscreen_svg_images(text)) {
-        QRegularExpression svg_height("<\\s*svg\\s[^>]*height\\s*=\\s*[\"'](100%)[\"'][^>]*>",
-                                     QRegularExpression::CaseInsensitiveOption |
-                                     QRegularExpression::MultilineOption | 
-                                     QRegularExpression::DotMatchesEverythingOption);
-        QRegularExpressionMatch hmo = svg_height.match(text, 0);
-        if (hmo.hasMatch()) {
-            int bp = hmo.capturedStart(1);
-            int n = hmo.capturedLength(1);
-            text = text.replace(bp, n, "100vh"); 
-        }
+    // a single insert means text is scanned and shifted just once
+    if ((endheadpos > 1) && !injections.isEmpty()) {
+        text.insert(endheadpos, injections);
+    }
 
-        QRegularExpression svg_width("<\\s*svg\\s[^>]*width\\s*=\\s*[\"'](100%)[\"'][^>]*>",
-                                    QRegularExpression::CaseInsensitiveOption |
-                                    QRegularExpression::MultilineOption | 
-                                    QRegularExpression::DotMatchesEverythingOption);
-        QRegularExpressionMatch wmo = svg_width.match(text, 0);
-        if (wmo.hasMatch()) {
-            int bp = wmo.capturedStart(1);
-            int n = wmo.capturedLength(1);
-            text = text.replace(bp, n, "100vw"); 
+    // Probe with cheap substring checks before handing the document to
+    // Gumbo.  The fullscreen svg image fixup only ever applies to pages
+    // with a single svg wrapped image sized with width/height="100%", so
+    // the overwhelming majority of refreshes can skip the full parse.
+    int width_pos = -1;
+    int width_len = 0;
+    int height_pos = -1;
+    int height_len = 0;
+    bool maybe_svg_image = text.contains(QLatin1String("<image"), Qt::CaseInsensitive) &&
+                           text.contains(QLatin1String("<svg"), Qt::CaseInsensitive) &&
+                           text.contains(QLatin1String("100%"));
+    if (maybe_svg_image && fixup_fullscreen_svg_images(text, width_pos, width_len, height_pos, height_len)) {
+        // splice both replacement values in with one rebuild of text;
+        // two replace() calls would each memmove the whole tail since
+        // the replacements differ in length from the original values
+        int first_pos = width_pos;
+        int first_len = width_len;
+        int second_pos = height_pos;
+        int second_len = height_len;
+        QLatin1String first_repl("100vw");
+        QLatin1String second_repl("100vh");
+        if (second_pos < first_pos) {
+            qSwap(first_pos, second_pos);
+            qSwap(first_len, second_len);
+            qSwap(first_repl, second_repl);
         }
+        QString out;
+        out.reserve(text.size() + 2);
+        out.append(text.midRef(0, first_pos));
+        out.append(first_repl);
+        out.append(text.midRef(first_pos + first_len, second_pos - (first_pos + first_len)));
+        out.append(second_repl);
+        out.append(text.midRef(second_pos + second_len));
+        text = out;
     }
 
     m_Filepath = filename_url;
+    // remember what this page was built from so a later css-only change
+    // can be applied in place without a reload
+    m_lastTextSize = textsize;
+    m_lastTextHash = texthash;
+    m_lastDark = usedark;
+    m_lastUserCssUrl = m_usercssurl;
     m_Preview->CustomSetDocument(filename_url, text);
 
-    m_progress->setValue(10);
-    return true;
+    progress()->setValue(10);
 }
 
 void PreviewWindow::UpdatePageDone()
 {
-    if (!m_Preview->WasLoadOkay()) qDebug() << "PV loadFinished with okay set to false!";
+    if (!m_Preview->WasLoadOkay()) qCWarning(lcPreview) << "PV loadFinished with okay set to false!";
  
-    DBG qDebug() << "PreviewWindow UpdatePage load is Finished";
-    DBG qDebug() << "PreviewWindow UpdatePage final step scroll to location";
+    qCDebug(lcPreview) << "PreviewWindow UpdatePage load is Finished";
+    qCDebug(lcPreview) << "PreviewWindow UpdatePage final step scroll to location";
 
     // Zoom is handled internally to mPreview just before this is called
     UpdateWindowTitle();
     m_OverlayTimer.stop();
-    m_progress->setValue(100);
-    m_progress->reset();
+    progress()->setValue(100);
+    progress()->reset();
     m_Preview->HideOverlay();
+    m_updatingPage = false;
+
+    // a newer request arrived while this page was loading; it will replace
+    // this page momentarily, so do not waste the scroll round-trips into
+    // the render process on a page the user will never see
+    if (m_havePending) {
+        m_DebounceTimer.start();
+        return;
+    }
+
     // need to delay long enough for Zoom changes to be reflected in View widget
     // before trying to center it on a location.
     QTimer::singleShot(30, this, SLOT(DelayedScrollTo()));
-    m_updatingPage = false;
 }
 
 void PreviewWindow::DelayedScrollTo()
@@ -369,13 +574,17 @@ void PreviewWindow::DelayedScrollTo()
     m_Preview->ExecuteCaretUpdate();
 }
 
-void PreviewWindow::ScrollTo(QList<ElementIndex> location)
+void PreviewWindow::ScrollTo(const QVector<ElementIndex> &location)
 {
-    DBG qDebug() << "received a PreviewWindow ScrollTo event";
+    qCDebug(lcPreview) << "received a PreviewWindow ScrollTo event";
     if (!m_Preview->isVisible()) {
         return;
     }
-    DBG foreach(ElementIndex ei, location) qDebug() << "name: " << ei.name << " index: " << ei.index;
+    if (lcPreview().isDebugEnabled()) {
+        for (const ElementIndex &ei : location) {
+            qCDebug(lcPreview) << "name: " << ei.name << " index: " << ei.index;
+        }
+    }
     SetCaretLocation(location);
     if (!m_updatingPage) {
         m_Preview->StoreCaretLocationUpdate(m_location);
@@ -388,13 +597,20 @@ void PreviewWindow::UpdateWindowTitle()
     if ((m_Preview) && m_Preview->isVisible()) {
         int height = m_Preview->height();
         int width = m_Preview->width();
-        QString filename;
-        if (!m_Filepath.isEmpty()) {
-            filename = QFileInfo(m_Filepath).fileName();
+        // skip rebuilding the title string when nothing it shows has changed
+        // (resizeEvent calls this continuously while the dock is dragged)
+        if ((width != m_lastTitleWidth) || (height != m_lastTitleHeight) || (m_Filepath != m_lastTitlePath)) {
+            m_lastTitleWidth = width;
+            m_lastTitleHeight = height;
+            m_lastTitlePath = m_Filepath;
+            QString filename;
+            if (!m_Filepath.isEmpty()) {
+                filename = QFileInfo(m_Filepath).fileName();
+            }
+            setTitleText(tr("Preview") %
+                            QLatin1String(" (") % QString::number(width) % QLatin1Char('x') %
+                            QString::number(height) % QLatin1String(") ") % filename);
         }
-        setTitleText(tr("Preview") + 
-                        " (" + QString::number(width) + "x" + QString::number(height) + ") " +
-                        filename);
     }
     // qDebug() << "QDockWidget" << isFloating() << isVisible();
     if (isFloating()) {
@@ -408,9 +624,12 @@ void PreviewWindow::UpdateWindowTitle()
 // (when QDockWidget is tabified)
 void PreviewWindow::setTitleText(const QString &text)
 {
+    if (text == m_titleText) return;
     m_titleText = text;
     // qDebug() << "In setTitleText: " << text;
-    repaint();
+    // update() lets Qt coalesce paint requests instead of forcing a
+    // synchronous repaint for every title change during a resize drag
+    update();
 }
 
 const QString PreviewWindow::titleText()
@@ -424,38 +643,39 @@ const QString PreviewWindow::titleText()
 // Needed to update Preview's title when undocked on some platforms
 void PreviewWindow::previewFloated(bool wasFloated) {
     // qDebug() << "In previewFloated (pre-if): " << wasFloated;
+    m_optDirty = true;
     if (wasFloated) {
         // qDebug() << "In previewFloated: (post-if)" << wasFloated;
         UpdateWindowTitle();
     }
 }
 
-QList<ElementIndex> PreviewWindow::GetCaretLocation()
+QVector<ElementIndex> PreviewWindow::GetCaretLocation()
 {
-    DBG qDebug() << "PreviewWindow in GetCaretLocation";
-    QList<ElementIndex> hierarchy = m_Preview->GetCaretLocation();
+    qCDebug(lcPreview) << "PreviewWindow in GetCaretLocation";
+    QVector<ElementIndex> hierarchy = m_Preview->GetCaretLocation();
     for (int i = 0; i < hierarchy.length(); i++) {
         if (m_usingMathML && (hierarchy[i].name == "body")) {
             // compensate for MathJax added two divs injected as first children of body
             hierarchy[i].index = hierarchy[i].index - 2;
         }
-        DBG qDebug() << "name: " << hierarchy[i].name << " index: " << hierarchy[i].index;
+        qCDebug(lcPreview) << "name: " << hierarchy[i].name << " index: " << hierarchy[i].index;
     }
     return hierarchy;
 }
 
 
-void PreviewWindow::SetCaretLocation(const QList<ElementIndex> &loc)
+void PreviewWindow::SetCaretLocation(const QVector<ElementIndex> &loc)
 {
-    DBG qDebug() << "PreviewWindow in SetCaretLocation";
-    QList<ElementIndex> hierarchy;
-    foreach(ElementIndex ei, loc) {
+    qCDebug(lcPreview) << "PreviewWindow in SetCaretLocation";
+    QVector<ElementIndex> hierarchy;
+    for (ElementIndex ei : loc) {
         if (m_usingMathML && (ei.name == "body")) {
             // compensate for MathJax added two divs injected as first children of body
             ei.index = ei.index + 2;
         }
         hierarchy << ei;
-        DBG qDebug() << "name: " << ei.name << " index: " << ei.index;
+        qCDebug(lcPreview) << "name: " << ei.name << " index: " << ei.index;
     }
     m_location = hierarchy;
     // Any Zoom must come *before* we do any caret updating
@@ -469,7 +689,7 @@ void PreviewWindow::SetZoomFactor(float factor)
 
 void PreviewWindow::EmitGoToPreviewLocationRequest()
 {
-    DBG qDebug() << "EmitGoToPreviewLocationRequest request";
+    qCDebug(lcPreview) << "EmitGoToPreviewLocationRequest request";
     emit GoToPreviewLocationRequest();
 }
 
@@ -478,7 +698,7 @@ bool PreviewWindow::eventFilter(QObject *object, QEvent *event)
   switch (event->type()) {
     case QEvent::ChildAdded:
       if (object == m_Preview) {
-          DBG qDebug() << "child add event";
+          qCDebug(lcPreview) << "child add event";
           const QChildEvent *childEvent(static_cast<QChildEvent*>(event));
           if (childEvent->child()) {
               childEvent->child()->installEventFilter(this);
@@ -487,20 +707,20 @@ bool PreviewWindow::eventFilter(QObject *object, QEvent *event)
       break;
     case QEvent::MouseButtonPress:
       {
-          DBG qDebug() << "Preview mouse button press event " << object;
+          qCDebug(lcPreview) << "Preview mouse button press event " << object;
           const QMouseEvent *mouseEvent(static_cast<QMouseEvent*>(event));
           if (mouseEvent) {
               if (mouseEvent->button() == Qt::LeftButton) {
-                  DBG qDebug() << "Detected Left Mouse Button Press Event";
+                  qCDebug(lcPreview) << "Detected Left Mouse Button Press Event";
                   QString hoverurl = m_Preview->GetHoverUrl();
                   if (hoverurl.isEmpty()) {
-                       DBG qDebug() << "emitting GoToPreviewLocationRequest";
+                       qCDebug(lcPreview) << "emitting GoToPreviewLocationRequest";
                       QTimer::singleShot(50, this, SLOT(EmitGoToPreviewLocationRequest()));
                   } else {
                       QUrl link2url(hoverurl);
                       QUrl currenturl(m_Preview->url());
-                      DBG qDebug() << "mouse press with : " << link2url.toString();
-                      DBG qDebug() << "  with current url: " << currenturl.toString();
+                      qCDebug(lcPreview) << "mouse press with : " << link2url.toString();
+                      qCDebug(lcPreview) << "  with current url: " << currenturl.toString();
                       QString fragment;
                       if (link2url.hasFragment()) {
                           fragment = link2url.fragment();
@@ -512,7 +732,7 @@ bool PreviewWindow::eventFilter(QObject *object, QEvent *event)
                       // test for local in-page link
                       // otherwise do nothing and acceptNavigationRequest will handle it
                       if (link2url == currenturl) {
-                          DBG qDebug() << "we have a local link to fragment: " << fragment;
+                          qCDebug(lcPreview) << "we have a local link to fragment: " << fragment;
                           // tell current CV tab to scroll to fragment or top
                           emit ScrollToFragmentRequest(fragment);  
                        }
@@ -528,11 +748,11 @@ bool PreviewWindow::eventFilter(QObject *object, QEvent *event)
       break;
     case QEvent::MouseButtonRelease:
       {
-          DBG qDebug() << "Preview mouse button release event " << object;
+          qCDebug(lcPreview) << "Preview mouse button release event " << object;
           const QMouseEvent *mouseEvent(static_cast<QMouseEvent*>(event));
           if (mouseEvent) {
               if (mouseEvent->button() == Qt::LeftButton) {
-                  DBG qDebug() << "Detected Left Mouse Button Release Event";
+                  qCDebug(lcPreview) << "Detected Left Mouse Button Release Event";
               }
           }
       }
@@ -545,7 +765,7 @@ bool PreviewWindow::eventFilter(QObject *object, QEvent *event)
 
 void PreviewWindow::LinkClicked(const QUrl &url)
 {
-    DBG qDebug() << "in PreviewWindow LinkClicked with url :" << url.toString();
+    qCDebug(lcPreview) << "in PreviewWindow LinkClicked with url :" << url.toString();
 
     if (url.toString().isEmpty()) {
         return;
@@ -567,22 +787,22 @@ void PreviewWindow::LinkClicked(const QUrl &url)
 
 void PreviewWindow::InspectorClosed(int i)
 {
-    DBG qDebug() << "received finished with argument: " << i;
+    qCDebug(lcPreview) << "received finished with argument: " << i;
 }
 
 void PreviewWindow::InspectPreviewPage()
 {
     // non-modal dialog
-    if (!m_Inspector->isVisible()) {
-        DBG qDebug() << "inspecting";
-        m_Inspector->InspectPageofView(m_Preview);
-        m_Inspector->show();
-        m_Inspector->raise();
-        m_Inspector->activateWindow();
+    if (!inspector()->isVisible()) {
+        qCDebug(lcPreview) << "inspecting";
+        inspector()->InspectPageofView(m_Preview);
+        inspector()->show();
+        inspector()->raise();
+        inspector()->activateWindow();
         return;
     }
-    m_Inspector->StopInspection();
-    m_Inspector->close();
+    inspector()->StopInspection();
+    inspector()->close();
 }
 
 void PreviewWindow::SelectAllPreview()
@@ -601,7 +821,9 @@ void PreviewWindow::ReloadPreview()
     // m_Preview->triggerPageAction(QWebEnginePage::Reload);
 
     //force reset m_updatingPage in case a signal is lost
-    m_progress->reset();
+    if (m_progress) {
+        m_progress->reset();
+    }
     m_OverlayTimer.stop();
     m_Preview->HideOverlay();
     m_updatingPage = false;
@@ -611,7 +833,7 @@ void PreviewWindow::ReloadPreview()
 void PreviewWindow::setProgress(int val)
 {
     if (val > 10 && val < 100) {
-      m_progress->setValue(val);
+      progress()->setValue(val);
     }
 }
 
@@ -633,73 +855,170 @@ void PreviewWindow::ConnectSignalsToSlots()
     connect(m_selectAction,  SIGNAL(triggered()),           this, SLOT(SelectAllPreview()));
     connect(m_copyAction,    SIGNAL(triggered()),           this, SLOT(CopyPreview()));
     connect(m_reloadAction,  SIGNAL(triggered()),           this, SLOT(ReloadPreview()));
-    connect(m_Inspector,     SIGNAL(finished(int)),         this, SLOT(InspectorClosed(int)));
+    // the Inspector's finished(int) signal is connected when it is
+    // first created - see inspector()
     connect(this,     SIGNAL(topLevelChanged(bool)),        this, SLOT(previewFloated(bool)));
 }
 
+// Returns true as soon as any text node under this node contains a
+// non-whitespace character.  Checking for an "empty" header this way is
+// O(1) for non-empty ones, where get_local_text_of_node would walk the
+// whole subtree and concatenate it into a QString just to call isEmpty()
+static bool gumbo_subtree_has_text(const GumboNode* node)
+{
+    if ((node->type == GUMBO_NODE_TEXT) || (node->type == GUMBO_NODE_CDATA)) {
+        const char* p = node->v.text.text;
+        while (*p) {
+            if (!isspace(static_cast<unsigned char>(*p))) return true;
+            p++;
+        }
+        return false;
+    }
+    if (node->type != GUMBO_NODE_ELEMENT) return false;
+    const GumboVector* children = &node->v.element.children;
+    for (unsigned int i = 0; i < children->length; ++i) {
+        if (gumbo_subtree_has_text(static_cast<GumboNode*>(children->data[i]))) return true;
+    }
+    return false;
+}
+
+// GumboInterface::parse() removes any leading xml declaration (and the
+// whitespace that follows it) before parsing, so mirror that here to allow
+// gumbo byte offsets to be related back to positions in the original text
+static int skip_xml_declaration(const QString &text)
+{
+    if (!text.startsWith(QLatin1String("<?xml"))) return 0;
+    int end = text.indexOf(QChar('>'), 5);
+    if (end < 0) return 0;
+    end++;
+    while (end < text.length()) {
+        const QChar c = text.at(end);
+        if ((c != '\n') && (c != '\r') && (c != '\t') && (c != '\v') && (c != '\f') && (c != ' ')) break;
+        end++;
+    }
+    return end;
+}
+
+// Gumbo reports source positions as byte offsets into the utf-8 buffer it
+// parsed.  Walk text forward from the QChar position pos (whose utf-8 byte
+// offset is bytes) until byte_offset is reached and return the QChar position
+static int pos_from_byte_offset(const QString &text, int pos, int bytes, int byte_offset)
+{
+    while ((bytes < byte_offset) && (pos < text.length())) {
+        const QChar c = text.at(pos);
+        if (c.isHighSurrogate()) {
+            bytes += 4;
+            pos += 2;
+        } else {
+            const ushort u = c.unicode();
+            bytes += (u < 0x80) ? 1 : ((u < 0x800) ? 2 : 3);
+            pos++;
+        }
+    }
+    return pos;
+}
+
 // Note: You can not use gumbo to perform the replacement as being
 // a repair parser, it will fix all kinds of mistakes hiding the errors
-bool PreviewWindow::fixup_fullscreen_svg_images(const QString &text) 
+bool PreviewWindow::fixup_fullscreen_svg_images(const QString &text,
+                                                int &width_pos, int &width_len,
+                                                int &height_pos, int &height_len)
 {
-    GumboInterface gi = GumboInterface(text, "any_version");
+    // a throwaway structural check never reports errors, so skip gumbo's
+    // per-character line/column bookkeeping (byte offsets are still tracked)
+    GumboInterface gi = GumboInterface(text, "any_version", GumboInterface::FastMode);
 
     QList<GumboNode*> image_tags = gi.get_all_nodes_with_tag(GUMBO_TAG_IMAGE);
     if (image_tags.count() != 1) return false;
 
-    QList<GumboNode*> svg_tags = gi.get_all_nodes_with_tag(GUMBO_TAG_SVG);
-    if (svg_tags.count() != 1) return false;
-
-    QList<GumboNode*> body_tags = gi.get_all_nodes_with_tag(GUMBO_TAG_BODY);
-    if (body_tags.count() != 1) return false;
-    
     GumboNode* image_node = image_tags.at(0);
-    GumboNode* svg_node   = svg_tags.at(0);
-    GumboNode* body_node  = body_tags.at(0);
+
+    // verify either body->div->svg->image or body->svg->image structure
+    // exists by climbing the parent chain from the image, comparing tag
+    // enums directly, instead of walking the whole tree again per tag
+    GumboNode* svg_node = image_node->parent;
+    if (!svg_node || (svg_node->type != GUMBO_NODE_ELEMENT) ||
+        (svg_node->v.element.tag != GUMBO_TAG_SVG)) {
+        return false;
+    }
+    GumboNode* body_node = svg_node->parent;
+    if (body_node && (body_node->type == GUMBO_NODE_ELEMENT) &&
+        (body_node->v.element.tag == GUMBO_TAG_DIV)) {
+        body_node = body_node->parent;
+    }
+    if (!body_node || (body_node->type != GUMBO_NODE_ELEMENT) ||
+        (body_node->v.element.tag != GUMBO_TAG_BODY)) {
+        return false;
+    }
 
     // loop through immediate children of body ignore script and style tags
     // and empty headers to make sure the div or svg is only child of body
-    QStringList child_names;
     int elcount = 0;
+    GumboTag first_child_tag = GUMBO_TAG_UNKNOWN;
     GumboVector* children = &body_node->v.element.children;
     for (unsigned int i = 0; i < children->length; ++i) {
         GumboNode* child = static_cast<GumboNode*>(children->data[i]);
-        if (child->type == GUMBO_NODE_ELEMENT) {
-            QString name = QString::fromStdString(gi.get_tag_name(child));
-            bool ignore_tag = (name == "script") || (name == "style");
-            if (HEADERTAGS.contains(name)) {
-                QString contents = gi.get_local_text_of_node(child);
-                ignore_tag = ignore_tag || contents.isEmpty();
-            }
-            if (!ignore_tag) {
-                child_names << name;
-                elcount++;
-            }
-            if (elcount > 1) break;
+        if (child->type != GUMBO_NODE_ELEMENT) continue;
+        // gumbo already knows the tag as an integer enum so switch on that
+        // instead of converting each tag name to a QString and comparing
+        switch (child->v.element.tag) {
+            case GUMBO_TAG_SCRIPT:
+            case GUMBO_TAG_STYLE:
+                continue;
+            case GUMBO_TAG_H1:
+            case GUMBO_TAG_H2:
+            case GUMBO_TAG_H3:
+            case GUMBO_TAG_H4:
+            case GUMBO_TAG_H5:
+            case GUMBO_TAG_H6:
+                if (!gumbo_subtree_has_text(child)) continue;
+                break;
+            default:
+                break;
         }
+        elcount++;
+        first_child_tag = child->v.element.tag;
+        if (elcount > 1) break;
     }
-    const QStringList allowed_tags = QStringList() << "div" << "svg"; 
-    if ((elcount != 1) || !allowed_tags.contains(child_names.at(0))) return false;
-    
-    // verify either body->div->svg->image or body->svg->image 
-    // structure exists (ignoring script and style tags)
-    GumboNode* anode = image_node;
-    QStringList path_pieces = QStringList() << QString::fromStdString(gi.get_tag_name(anode));
-    while (anode && !((anode->type == GUMBO_NODE_ELEMENT) && (anode->v.element.tag == GUMBO_TAG_BODY))) {
-        GumboNode* myparent = anode->parent;
-        QString parent_name = QString::fromStdString(gi.get_tag_name(myparent));
-        if ((parent_name != "script") && (parent_name != "style")) {
-            path_pieces.prepend(parent_name);
-        }
-        anode = myparent;
-    }
-    const QString apath = path_pieces.join(",");
-    if ((apath != "body,div,svg,image") && (apath != "body,svg,image")) return false;
-    
-    // finally check if svg height and width attributes are both "100%"
-    // and if so change them to 100vh and 100vw respectively
-    QHash<QString,QString> svgatts = gi.get_attributes_of_node(svg_node);
-    if ((svgatts.value("width","") == "100%") && (svgatts.value("height","") == "100%")) {
-        return true;
+    if ((elcount != 1) || ((first_child_tag != GUMBO_TAG_DIV) && (first_child_tag != GUMBO_TAG_SVG))) {
+        return false;
     }
-    return false;
+
+    // finally check if svg height and width attributes are both "100%" and
+    // if so hand back where each value lives in text so the caller can
+    // rewrite them to 100vw and 100vh without a second parse.  Peek at the
+    // two gumbo attributes directly rather than building a QHash of every
+    // attribute just to read back a pair of values
+    GumboAttribute* wattr = gumbo_get_attribute(&svg_node->v.element.attributes, "width");
+    GumboAttribute* hattr = gumbo_get_attribute(&svg_node->v.element.attributes, "height");
+    if (!wattr || !hattr) return false;
+    if ((strcmp(wattr->value, "100%") != 0) || (strcmp(hattr->value, "100%") != 0)) {
+        return false;
+    }
+    // original_value includes any surrounding quotes so strip them off
+    int woff = wattr->value_start.offset;
+    int wbytes = wattr->original_value.length;
+    if ((wbytes >= 2) && ((wattr->original_value.data[0] == '"') || (wattr->original_value.data[0] == '\''))) {
+        woff++;
+        wbytes -= 2;
+    }
+    int hoff = hattr->value_start.offset;
+    int hbytes = hattr->original_value.length;
+    if ((hbytes >= 2) && ((hattr->original_value.data[0] == '"') || (hattr->original_value.data[0] == '\''))) {
+        hoff++;
+        hbytes -= 2;
+    }
+    // both raw values decoded to "100%" so they are plain ascii and their
+    // byte lengths and QChar lengths agree
+    const int src_start = skip_xml_declaration(text);
+    if (woff <= hoff) {
+        width_pos  = pos_from_byte_offset(text, src_start, 0, woff);
+        height_pos = pos_from_byte_offset(text, width_pos, woff, hoff);
+    } else {
+        height_pos = pos_from_byte_offset(text, src_start, 0, hoff);
+        width_pos  = pos_from_byte_offset(text, height_pos, hoff, woff);
+    }
+    width_len = wbytes;
+    height_len = hbytes;
+    return true;
 }
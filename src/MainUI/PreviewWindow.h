@@ -29,6 +29,7 @@
 #include <QAction>
 #include <QtWebEngineWidgets/QWebEngineView>
 #include <QtWidgets/QDockWidget>
+#include <QStyleOption>
 #include <QTimer>
 #include <ViewEditors/Viewer.h>
 #include <Dialogs/Inspector.h>
@@ -39,6 +40,7 @@ class QWebEngineView;
 class QVBoxLayout;
 class QHBoxLayout;
 class QProgressBar;
+class QToolBar;
 class OverlayHelperWidget;
 
 class PreviewWindow : public QDockWidget
@@ -48,8 +50,8 @@ class PreviewWindow : public QDockWidget
 public:
     PreviewWindow(QWidget *parent = 0);
     ~PreviewWindow();
-    QList<ElementIndex> GetCaretLocation();
-    void SetCaretLocation(const QList<ElementIndex> &loc);
+    QVector<ElementIndex> GetCaretLocation();
+    void SetCaretLocation(const QVector<ElementIndex> &loc);
     bool IsVisible();
     bool HasFocus();
     float GetZoomFactor();
@@ -58,10 +60,12 @@ public:
     void setUserCSSURL(QString usercssurl) { m_usercssurl = usercssurl; }
 
 public slots:
-    bool UpdatePage(QString filename, QString text, QList<ElementIndex> location);
+    // text is taken by value so callers that no longer need their buffer can
+    // std::move() it in and avoid a deep copy when it is modified in place
+    bool UpdatePage(const QString &filename, QString text, const QVector<ElementIndex> &location);
     void UpdatePageDone();
     void DelayedScrollTo();
-    void ScrollTo(QList<ElementIndex> location);
+    void ScrollTo(const QVector<ElementIndex> &location);
     void SetZoomFactor(float factor);
     void LinkClicked(const QUrl &url);
     void EmitGoToPreviewLocationRequest();
@@ -80,6 +84,9 @@ public slots:
     void setTitleText(const QString &text);
     void previewFloated(bool wasFloated);
 
+private slots:
+    void DoUpdatePage();
+
 signals:
     void Shown();
     void ZoomFactorChanged(float factor);
@@ -104,6 +111,8 @@ protected:
     virtual void hideEvent(QHideEvent* event);
     virtual void showEvent(QShowEvent* event);
     void resizeEvent(QResizeEvent * event);
+    virtual void moveEvent(QMoveEvent* event);
+    virtual void changeEvent(QEvent* event);
 
     /**
      * Reimplemented from QDockWidget to enable setTitleText()
@@ -116,9 +125,17 @@ private:
     void LoadSettings();
     void ConnectSignalsToSlots();
     void UpdateWindowTitle();
-    bool fixup_fullscreen_svg_images(const QString &text);
+    bool fixup_fullscreen_svg_images(const QString &text,
+                                     int &width_pos, int &width_len,
+                                     int &height_pos, int &height_len);
     void SetupOverlayTimer();
-    
+    void SetupDebounceTimer();
+
+    // lazily construct the Inspector (drags in WebEngine dev tools
+    // machinery) and the progress bar on first use
+    Inspector *inspector();
+    QProgressBar *progress();
+
     const QString titleText();
 
     QWidget *m_MainWidget;
@@ -129,10 +146,16 @@ private:
     ViewPreview *m_Preview;
     Inspector *m_Inspector;
     QProgressBar* m_progress;
+    QToolBar *m_toolbar;
 
     QString m_Filepath;
     QString m_titleText;
 
+    // what the current title text was built from, to skip rebuilding it
+    int m_lastTitleWidth;
+    int m_lastTitleHeight;
+    QString m_lastTitlePath;
+
     QString m_mathjaxurl;
     QString m_usercssurl;
 
@@ -141,11 +164,31 @@ private:
     QAction * m_copyAction;
     QAction * m_reloadAction;
 
-    QList<ElementIndex> m_location;
-    
+    QVector<ElementIndex> m_location;
+
+    // what the currently loaded page was built from, used to detect
+    // refreshes where only the user stylesheet changed
+    int m_lastTextSize;
+    uint m_lastTextHash;
+    bool m_lastDark;
+    QString m_lastUserCssUrl;
+
+    // the most recent UpdatePage request, waiting on the debounce timer
+    QString m_pendingUrl;
+    QString m_pendingText;
+    QVector<ElementIndex> m_pendingLocation;
+    bool m_havePending;
+
     QTimer m_OverlayTimer;
+    QTimer m_DebounceTimer;
     bool m_updatingPage;
     bool m_usingMathML;
+
+    // style options used by paintEvent, rebuilt only when widget state
+    // changes rather than on every repaint
+    QStyleOptionDockWidget m_cachedOpt;
+    QStyleOptionFrame m_cachedFrameOpt;
+    bool m_optDirty;
 };
 
 #endif // PREVIEWWINDOW_H
@@ -72,9 +72,10 @@
 
 static const QString URL_SAFE = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_.-/~";
 
+// the stable ids let an already loaded page swap these nodes in place
 static const QString DARK_STYLE =
-    "<style>:root { background-color: %1; color: %2; } ::-webkit-scrollbar { display: none; }</style>"
-    "<link rel=\"stylesheet\" type=\"text/css\" href=\"%3\" />";
+    "<style id=\"__sigil_dark_css\">:root { background-color: %1; color: %2; } ::-webkit-scrollbar { display: none; }</style>"
+    "<link id=\"__sigil_dark_scrollbar_css\" rel=\"stylesheet\" type=\"text/css\" href=\"%3\" />";
 
 #ifndef MAX_PATH
 // Set Max length to 256 because that's the max path size on many systems.
@@ -1206,6 +1207,13 @@ QString Utility::AddDarkCSS(const QString &html)
     QString text = html;
     int endheadpos = text.indexOf("</head>");
     if (endheadpos == -1) return text;
+    // qDebug() << "Injecting dark style: ";
+    text.insert(endheadpos, GetDarkCSS());
+    return text;
+}
+
+QString Utility::GetDarkCSS()
+{
     QPalette pal = qApp->palette();
     QString back = pal.color(QPalette::Base).name();
     QString fore = pal.color(QPalette::Text).name();
@@ -1217,10 +1225,7 @@ QString Utility::AddDarkCSS(const QString &html)
 #else
     QString dark_css_url = "qrc:///dark/lin_dark_scrollbar.css";
 #endif
-    QString inject_dark_style = DARK_STYLE.arg(back).arg(fore).arg(dark_css_url);
-    // qDebug() << "Injecting dark style: ";
-    text.insert(endheadpos, inject_dark_style);
-    return text;
+    return DARK_STYLE.arg(back).arg(fore).arg(dark_css_url);
 }
 
 
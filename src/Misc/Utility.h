@@ -230,6 +230,8 @@ public:
     // inject dark mode css into html for Preview, AVTab, ImageTab, ViewImage, and SelectFiles
     static QString AddDarkCSS(const QString &html);
 
+    static QString GetDarkCSS();
+
     // return the proper background color for QWebEngineView
     static QColor WebViewBackgroundColor(bool followpref = false);
     
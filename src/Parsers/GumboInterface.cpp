@@ -124,7 +124,24 @@ GumboInterface::GumboInterface(const QString &source, const QString &version)
       m_currentdir(""),
       m_newbody(""),
       m_version(version),
-      m_newbookpath("")
+      m_newbookpath(""),
+      m_parsemode(DefaultMode)
+{
+}
+
+
+GumboInterface::GumboInterface(const QString &source, const QString &version, ParseMode mode)
+    : m_source(source),
+      m_output(NULL),
+      m_utf8src(""),
+      m_sourceupdates(EmptyHash),
+      m_newcsslinks(""),
+      m_currentbkpath(""),
+      m_currentdir(""),
+      m_newbody(""),
+      m_version(version),
+      m_newbookpath(""),
+      m_parsemode(mode)
 {
 }
 
@@ -139,7 +156,8 @@ GumboInterface::GumboInterface(const QString &source, const QString &version, co
       m_currentdir(""),
       m_newbody(""),
       m_version(version),
-      m_newbookpath("")
+      m_newbookpath(""),
+      m_parsemode(DefaultMode)
 {
 }
 
@@ -178,6 +196,7 @@ void GumboInterface::parse()
         myoptions.stop_on_first_error = false;
         myoptions.max_tree_depth = 400;
         myoptions.max_errors = 50;
+        myoptions.track_source_positions = (m_parsemode != FastMode);
 
         // GumboInterface::m_mutex.lock();
         m_output = gumbo_parse_with_options(&myoptions, m_utf8src.data(), m_utf8src.length());
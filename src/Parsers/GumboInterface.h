@@ -48,7 +48,15 @@ class GumboInterface
 {
 public:
 
+    enum ParseMode {
+        DefaultMode = 0,
+        // skips gumbo's per-character line/column bookkeeping (byte offsets
+        // are still tracked) for throwaway parses that never report errors
+        FastMode    = 1
+    };
+
     GumboInterface(const QString &source, const QString &version);
+    GumboInterface(const QString &source, const QString &version, ParseMode mode);
     GumboInterface(const QString &source, const QString &version, const QHash<QString, QString> &source_updates);
     ~GumboInterface();
 
@@ -186,7 +194,8 @@ private:
     std::string                     m_newbody;
     QString                         m_version;
     QString                         m_newbookpath;
-    
+    ParseMode                       m_parsemode;
+
 };
 
 #endif
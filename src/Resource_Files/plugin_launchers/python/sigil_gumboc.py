@@ -373,6 +373,7 @@ class Options(ctypes.Structure):
         ('stop_on_first_error', ctypes.c_bool),
         ('max_tree_depth', ctypes.c_uint),
         ('max_errors', ctypes.c_int),
+        ('track_source_positions', ctypes.c_bool),
         ]
 
 
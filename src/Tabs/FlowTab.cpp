@@ -485,7 +485,7 @@ bool FlowTab::ToggleAutoSpellcheckEnabled()
     return false;
 }
 
-void FlowTab::GoToCaretLocation(QList<ElementIndex> location)
+void FlowTab::GoToCaretLocation(QVector<ElementIndex> location)
 {
     if (location.isEmpty()) {
         return;
@@ -496,12 +496,12 @@ void FlowTab::GoToCaretLocation(QList<ElementIndex> location)
     }
 }
 
-QList<ElementIndex> FlowTab::GetCaretLocation()
+QVector<ElementIndex> FlowTab::GetCaretLocation()
 {
     if (m_wCodeView) {
         return m_wCodeView->GetCaretLocation();
     }
-    return QList<ElementIndex>();
+    return QVector<ElementIndex>();
 }
 
 QString FlowTab::GetCaretLocationUpdate() const
@@ -99,9 +99,9 @@ public:
 
     bool InsertFileEnabled();
 
-    QList<ElementIndex> GetCaretLocation();
+    QVector<ElementIndex> GetCaretLocation();
     QString GetCaretLocationUpdate() const;
-    void GoToCaretLocation(QList<ElementIndex> location);
+    void GoToCaretLocation(QVector<ElementIndex> location);
 
     QString GetDisplayedCharacters();
     QString GetText();
@@ -91,7 +91,7 @@ CodeViewEditor::CodeViewEditor(HighlighterType high_type, bool check_spelling, Q
     m_ScrollOneLineDown(new QShortcut(QKeySequence(Qt::ControlModifier + Qt::Key_Down), this, 0, 0, Qt::WidgetShortcut)),
     m_isLoadFinished(false),
     m_DelayedCursorScreenCenteringRequired(false),
-    m_CaretUpdate(QList<ElementIndex>()),
+    m_CaretUpdate(QVector<ElementIndex>()),
     m_checkSpelling(check_spelling),
     m_reformatCSSEnabled(false),
     m_reformatHTMLEnabled(false),
@@ -2439,7 +2439,7 @@ QString CodeViewEditor::GetCaretElementName()
     return m_element_name;
 }
 
-QList<ElementIndex> CodeViewEditor::GetCaretLocation()
+QVector<ElementIndex> CodeViewEditor::GetCaretLocation()
 {
     // We search for the first opening tag *behind* the caret.
     // This specifies the element the caret is located in.
@@ -2460,7 +2460,7 @@ QList<ElementIndex> CodeViewEditor::GetCaretLocation()
         offset = start;
         len = mo.capturedLength();
     }
-    QList<ElementIndex> hierarchy = ConvertStackToHierarchy(GetCaretLocationStack(offset + len));
+    QVector<ElementIndex> hierarchy = ConvertStackToHierarchy(GetCaretLocationStack(offset + len));
 
     // determine last block element containing caret
     QString element_name;
@@ -2475,7 +2475,7 @@ QList<ElementIndex> CodeViewEditor::GetCaretLocation()
 }
 
 
-void CodeViewEditor::StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy)
+void CodeViewEditor::StoreCaretLocationUpdate(const QVector<ElementIndex> &hierarchy)
 {
     m_CaretUpdate = hierarchy;
 }
@@ -2526,7 +2526,7 @@ QStack<CodeViewEditor::StackElement> CodeViewEditor::GetCaretLocationStack(int o
 }
 
 
-QString CodeViewEditor::ConvertHierarchyToQWebPath(const QList<ElementIndex>& hierarchy) const
+QString CodeViewEditor::ConvertHierarchyToQWebPath(const QVector<ElementIndex>& hierarchy) const
 {
     QStringList pathparts;
     for (int i=0; i < hierarchy.count(); i++) {
@@ -2537,9 +2537,9 @@ QString CodeViewEditor::ConvertHierarchyToQWebPath(const QList<ElementIndex>& hi
 }
 
 
-QList<ElementIndex> CodeViewEditor::ConvertStackToHierarchy(const QStack<StackElement> stack) const
+QVector<ElementIndex> CodeViewEditor::ConvertStackToHierarchy(const QStack<StackElement> stack) const
 {
-    QList<ElementIndex> hierarchy;
+    QVector<ElementIndex> hierarchy;
     foreach(StackElement stack_element, stack) {
         ElementIndex new_element;
         new_element.name  = stack_element.name;
@@ -2550,7 +2550,7 @@ QList<ElementIndex> CodeViewEditor::ConvertStackToHierarchy(const QStack<StackEl
 }
 
 
-std::tuple<int, int> CodeViewEditor::ConvertHierarchyToCaretMove(const QList<ElementIndex> &hierarchy) const
+std::tuple<int, int> CodeViewEditor::ConvertHierarchyToCaretMove(const QVector<ElementIndex> &hierarchy) const
 {
     QString source = toPlainText();
     QString version = "any_version";
@@ -278,10 +278,10 @@ public:
     QString GetCaretElementName();
 
     // inherited
-    QList<ElementIndex> GetCaretLocation();
+    QVector<ElementIndex> GetCaretLocation();
 
     // inherited
-    void StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy);
+    void StoreCaretLocationUpdate(const QVector<ElementIndex> &hierarchy);
 
     // inherited
     bool ExecuteCaretUpdate(bool default_to_top = false);
@@ -687,11 +687,11 @@ private:
      * @param stack The StackElement stack.
      * @return The converted ElementIndex hierarchy.
      */
-    QList<ElementIndex> ConvertStackToHierarchy(const QStack<StackElement> stack) const;
+    QVector<ElementIndex> ConvertStackToHierarchy(const QStack<StackElement> stack) const;
 
 
     // Used to convert Hierarchy to QWedPath used by BV and Gumbo
-    QString ConvertHierarchyToQWebPath(const QList<ElementIndex>& hierarchy) const;
+    QString ConvertHierarchyToQWebPath(const QVector<ElementIndex>& hierarchy) const;
 
     /**
      * Converts a ViewEditor element hierarchy to a tuple describing necessary caret moves.
@@ -700,7 +700,7 @@ private:
      * @param hierarchy The caret location as ElementIndex hierarchy.
      * @return The info needed to move the caret to the new location.
      */
-    std::tuple<int, int> ConvertHierarchyToCaretMove(const QList<ElementIndex> &hierarchy) const;
+    std::tuple<int, int> ConvertHierarchyToCaretMove(const QVector<ElementIndex> &hierarchy) const;
 
     /**
      * Insert HTML tags around the current selection.
@@ -825,7 +825,7 @@ private:
      * Stores the update for the caret location
      * when switching from BookView to CodeView.
      */
-    QList<ElementIndex> m_CaretUpdate;
+    QVector<ElementIndex> m_CaretUpdate;
 
     /**
      * Whether spell checking is enabled on this view.
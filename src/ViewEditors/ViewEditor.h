@@ -74,8 +74,8 @@ public:
      *
      * @return The element selecting list.
      */
-    virtual QList<ElementIndex> GetCaretLocation(bool normalize=false) {
-        return QList<ElementIndex>();
+    virtual QVector<ElementIndex> GetCaretLocation(bool normalize=false) {
+        return QVector<ElementIndex>();
     }
 
     /**
@@ -85,7 +85,7 @@ public:
      *
      * @param hierarchy The element selecting list.
      */
-    virtual void StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy) {}
+    virtual void StoreCaretLocationUpdate(const QVector<ElementIndex> &hierarchy) {}
 
     virtual QString GetCaretLocationUpdate() {
         return QString();
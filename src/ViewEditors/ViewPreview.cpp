@@ -398,7 +398,7 @@ void ViewPreview::WebPageJavascriptOnLoad()
     emit DocumentLoaded();
 }
 
-QString ViewPreview::GetElementSelectingJS_NoTextNodes(const QList<ElementIndex> &hierarchy) const
+QString ViewPreview::GetElementSelectingJS_NoTextNodes(const QVector<ElementIndex> &hierarchy) const
 {
     // TODO: see if replacing jQuery with pure JS will speed up
     // caret location scrolling... note the children()/contents() difference:
@@ -428,7 +428,7 @@ QString ViewPreview::GetElementSelectingJS_NoTextNodes(const QList<ElementIndex>
     return element_selector;
 }
 
-QList<ElementIndex> ViewPreview::GetCaretLocation()
+QVector<ElementIndex> ViewPreview::GetCaretLocation()
 {
     // The location element hierarchy encoded in a string
     QString location_string = EvaluateJavascript(c_GetCaretLocation).toString();
@@ -436,12 +436,12 @@ QList<ElementIndex> ViewPreview::GetCaretLocation()
     return ConvertQWebPathToHierarchy(location_string);
 }
 
-QList<ElementIndex> ViewPreview::ConvertQWebPathToHierarchy(const QString & webpath) const
+QVector<ElementIndex> ViewPreview::ConvertQWebPathToHierarchy(const QString & webpath) const
 {
     // The location element hierarchy encoded in a string
     QString location_string = webpath;
     QStringList elements    = location_string.split(",", QString::SkipEmptyParts);
-    QList<ElementIndex> location;
+    QVector<ElementIndex> location;
     foreach(QString element, elements) {
         ElementIndex new_element;
         new_element.name  = element.split(" ")[ 0 ];
@@ -451,7 +451,7 @@ QList<ElementIndex> ViewPreview::ConvertQWebPathToHierarchy(const QString & webp
     return location;
 }
 
-QString ViewPreview::ConvertHierarchyToQWebPath(const QList<ElementIndex>& hierarchy)
+QString ViewPreview::ConvertHierarchyToQWebPath(const QVector<ElementIndex>& hierarchy)
 {
     QStringList pathparts;
     for (int i=0; i < hierarchy.count(); i++) {
@@ -470,7 +470,7 @@ void ViewPreview::StoreCurrentCaretLocation()
     }
 }
 
-void ViewPreview::StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy)
+void ViewPreview::StoreCaretLocationUpdate(const QVector<ElementIndex> &hierarchy)
 {
     DBG qDebug() << "in StoreCaretLocationUpdate";
     QString caret_location = "var element = " + GetElementSelectingJS_NoTextNodes(hierarchy) + ";";
@@ -481,7 +481,7 @@ void ViewPreview::StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy)
     m_CaretLocationUpdate = caret_location + scroll + SET_CURSOR_JS2 + "}";
 }
 
-QString ViewPreview::GetElementSelectingJS_WithTextNode(const QList<ElementIndex> &hierarchy) const
+QString ViewPreview::GetElementSelectingJS_WithTextNode(const QVector<ElementIndex> &hierarchy) const
 {
     QString element_selector = "$('html')";
 
@@ -86,14 +86,14 @@ public:
     void GrabFocus();
 
     // inherited
-    QList<ElementIndex> GetCaretLocation();
+    QVector<ElementIndex> GetCaretLocation();
 
     // methods for working with and converting QWebPaths to ElementIndex Lists 
-    QList<ElementIndex> ConvertQWebPathToHierarchy(const QString & webpath) const;
-    QString ConvertHierarchyToQWebPath(const QList<ElementIndex>& hierarchy);
+    QVector<ElementIndex> ConvertQWebPathToHierarchy(const QString & webpath) const;
+    QString ConvertHierarchyToQWebPath(const QVector<ElementIndex>& hierarchy);
 
     // inherited
-    void StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy);
+    void StoreCaretLocationUpdate(const QVector<ElementIndex> &hierarchy);
 
     // inherited
     bool ExecuteCaretUpdate();
@@ -182,7 +182,7 @@ private:
      *
      * @return The element-selecting JavaScript code.
      */
-    QString GetElementSelectingJS_NoTextNodes(const QList<ElementIndex> &hierarchy) const;
+    QString GetElementSelectingJS_NoTextNodes(const QVector<ElementIndex> &hierarchy) const;
 
     /**
      * Builds the element-selecting JavaScript code, ignoring all the
@@ -192,7 +192,7 @@ private:
      *
      * @return The element-selecting JavaScript code.
      */
-    QString GetElementSelectingJS_WithTextNode(const QList<ElementIndex> &hierarchy) const;
+    QString GetElementSelectingJS_WithTextNode(const QVector<ElementIndex> &hierarchy) const;
 
     /**
      * Connects all the required signals to their respective slots.
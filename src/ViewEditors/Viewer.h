@@ -65,8 +65,8 @@ public:
      *
      * @return The element selecting list.
      */
-    virtual QList<ElementIndex> GetCaretLocation() {
-        return QList<ElementIndex>();
+    virtual QVector<ElementIndex> GetCaretLocation() {
+        return QVector<ElementIndex>();
     }
 
     /**
@@ -76,7 +76,7 @@ public:
      *
      * @param hierarchy The element selecting list.
      */
-    virtual void StoreCaretLocationUpdate(const QList<ElementIndex> &hierarchy) {}
+    virtual void StoreCaretLocationUpdate(const QVector<ElementIndex> &hierarchy) {}
 
     virtual QString GetCaretLocationUpdate() {
         return QString();